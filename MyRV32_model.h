@@ -1,6 +1,12 @@
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
 
 class RV32I_RegisterFile final{
 private:
@@ -42,15 +48,169 @@ public:
     }
 };
 
-class RV32I_Processor final{
+enum class RV32I_WatchKind {
+    Read = 1,
+    Write = 2,
+    ReadWrite = 3
+};
+
+// Breakpoints and watchpoints. Memory is split into pages of 2^PAGE_SHIFT words,
+// and only flagged pages fall through to the exact lookup.
+class RV32I_DebugState final{
+public:
+    using BreakpointHook = std::function<void(int32_t pc)>;
+    using WatchpointHook = std::function<void(int32_t address, int32_t value, RV32I_WatchKind kind)>;
+
 private:
+    static constexpr int PAGE_SHIFT = 6;
+
+    struct Watchpoint {
+        int32_t begin;
+        int32_t end;
+        RV32I_WatchKind kind;
+        WatchpointHook hook;
+    };
+
+    std::unordered_map<int32_t, BreakpointHook> breakpoints;
+    std::map<int, Watchpoint> watchpoints;
+    int nextWatchpointId = 0;
+
+    int32_t _memSize;
+    std::vector<uint8_t> breakpointPages;
+    std::vector<uint8_t> watchpointPages;
+
+    static bool flagged(const std::vector<uint8_t>& pages, int32_t address) noexcept {
+        auto page = static_cast<uint32_t>(address) >> PAGE_SHIFT;
+        return page < pages.size() && pages[page];
+    }
+
+    // Flags the pages covering [first, last]; both addresses are already checked against the memory size.
+    static void mark(std::vector<uint8_t>& pages, int32_t first, int32_t last) noexcept {
+        for (auto page = first >> PAGE_SHIFT; page <= last >> PAGE_SHIFT; page++){
+            pages[page] = 1;
+        }
+    }
+
+    void rebuildBreakpointPages() {
+        std::fill(breakpointPages.begin(), breakpointPages.end(), 0);
+        for (const auto& [address, hook] : breakpoints){
+            mark(breakpointPages, address, address);
+        }
+    }
+
+    void rebuildWatchpointPages() {
+        std::fill(watchpointPages.begin(), watchpointPages.end(), 0);
+        for (const auto& [id, watch] : watchpoints){
+            mark(watchpointPages, watch.begin, watch.end - 1);
+        }
+    }
+
+public:
+    explicit RV32I_DebugState(int mem_size) : _memSize(mem_size),
+        breakpointPages(mem_size > 0 ? ((mem_size - 1) >> PAGE_SHIFT) + 1 : 0, 0),
+        watchpointPages(breakpointPages.size(), 0) {}
+
+    bool empty() const noexcept {
+        return breakpoints.empty() && watchpoints.empty();
+    }
+
+    void setBreakpoint(int32_t address, BreakpointHook hook) {
+        if (address < 0 || address >= _memSize)
+            throw std::runtime_error ("invalid breakpoint address = " + std::to_string(address));
+        breakpoints[address] = std::move(hook);
+        mark(breakpointPages, address, address);
+    }
+
+    void clearBreakpoint(int32_t address) {
+        if (breakpoints.erase(address))
+            rebuildBreakpointPages();
+    }
+
+    // Watches the word range [begin, end). Returns an id for removeWatchpoint().
+    int addWatchpoint(int32_t begin, int32_t end, RV32I_WatchKind kind, WatchpointHook hook) {
+        if (begin < 0 || end <= begin || end > _memSize)
+            throw std::runtime_error ("invalid watchpoint range = [" + std::to_string(begin) + ", " + std::to_string(end) + ")");
+        watchpoints[nextWatchpointId] = {begin, end, kind, std::move(hook)};
+        mark(watchpointPages, begin, end - 1);
+        return nextWatchpointId++;
+    }
+
+    void removeWatchpoint(int id) {
+        if (watchpoints.erase(id))
+            rebuildWatchpointPages();
+    }
+
+    // Hooks are copied before they run, so a hook may clear its own breakpoint or watchpoint.
+    void onFetch(int32_t pc) const {
+        if (!flagged(breakpointPages, pc))
+            return;
+        auto it = breakpoints.find(pc);
+        if (it != breakpoints.end()) {
+            auto hook = it->second;
+            hook(pc);
+        }
+    }
+
+    void onAccess(int32_t address, int32_t value, RV32I_WatchKind kind) const {
+        if (!flagged(watchpointPages, address))
+            return;
+        std::vector<WatchpointHook> hooks;
+        for (const auto& [id, watch] : watchpoints){
+            if (address >= watch.begin && address < watch.end &&
+                (static_cast<int>(watch.kind) & static_cast<int>(kind)))
+                hooks.push_back(watch.hook);
+        }
+        for (const auto& hook : hooks){
+            hook(address, value, kind);
+        }
+    }
+};
+
+// Compile-time processor configuration. Features that are turned off here are
+// removed from the execute loop with if constexpr instead of being checked at runtime.
+struct RV32I_Config {
+    static constexpr int XLEN = 32;
+    static constexpr bool M_EXTENSION = false;
+    static constexpr bool DEBUG_HOOKS = false;
+    static constexpr bool TRACE = false;
+    using Memory = RV32I_Memory;
+};
+
+struct RV32I_DebugConfig : RV32I_Config {
+    static constexpr bool DEBUG_HOOKS = true;
+};
+
+struct RV32IM_Config : RV32I_Config {
+    static constexpr bool M_EXTENSION = true;
+};
+
+struct RV32IM_FullConfig : RV32IM_Config {
+    static constexpr bool DEBUG_HOOKS = true;
+    static constexpr bool TRACE = true;
+};
+
+struct RV32I_NoFeature {
+    RV32I_NoFeature() = default;
+    explicit RV32I_NoFeature(int) {}
+};
+
+template <typename Config = RV32I_Config>
+class RV32_Processor final{
+public:
+    using TraceHook = std::function<void(int32_t pc, int32_t instruction)>;
+
+private:
+    static_assert(Config::XLEN == 32, "only XLEN = 32 is implemented");
+
     RV32I_RegisterFile regfile;
-    RV32I_Memory memory;
+    typename Config::Memory memory;
+    [[no_unique_address]] std::conditional_t<Config::DEBUG_HOOKS, RV32I_DebugState, RV32I_NoFeature> debug;
+    [[no_unique_address]] std::conditional_t<Config::TRACE, TraceHook, RV32I_NoFeature> traceHook;
     int32_t pc;
     int32_t _amountInstructions = 0;
 
 public:
-    RV32I_Processor(int mem_size, int32_t amountInstructions = 0) : memory(mem_size), pc(0), _amountInstructions(amountInstructions) {}
+    RV32_Processor(int mem_size, int32_t amountInstructions = 0) : memory(mem_size), debug(mem_size), pc(0), _amountInstructions(amountInstructions) {}
 
     void loadInstructionsMemory (const std::vector<int32_t>& instr) noexcept {
         for (int i = 0; i < instr.size(); i++){
@@ -74,8 +234,120 @@ public:
         memory.write(address, value);
     }
 
+    void setBreakpoint(int32_t address, RV32I_DebugState::BreakpointHook hook) requires Config::DEBUG_HOOKS {
+        debug.setBreakpoint(address, std::move(hook));
+    }
+
+    void clearBreakpoint(int32_t address) requires Config::DEBUG_HOOKS {
+        debug.clearBreakpoint(address);
+    }
+
+    int addWatchpoint(int32_t begin, int32_t end, RV32I_WatchKind kind, RV32I_DebugState::WatchpointHook hook) requires Config::DEBUG_HOOKS {
+        return debug.addWatchpoint(begin, end, kind, std::move(hook));
+    }
+
+    void removeWatchpoint(int id) requires Config::DEBUG_HOOKS {
+        debug.removeWatchpoint(id);
+    }
+
+    // Called with pc and the raw instruction before each instruction executes.
+    void setTraceHook(TraceHook hook) requires Config::TRACE {
+        traceHook = std::move(hook);
+    }
+
+    // Selects the loop once per call, so hooks that are compiled in but not set cost nothing per instruction.
     void execute() {
+        if constexpr (Config::TRACE) {
+            if (traceHook) {
+                dispatch<true>();
+                return;
+            }
+        }
+        dispatch<false>();
+    }
+
+private:
+    template <bool Trace>
+    void dispatch() {
+        if constexpr (Config::DEBUG_HOOKS) {
+            if (!debug.empty()) {
+                run<true, Trace>();
+                return;
+            }
+        }
+        run<false, Trace>();
+    }
+
+    static int32_t executeMulDiv(int funct3, int32_t lhs, int32_t rhs) {
+        auto ulhs = static_cast<uint32_t>(lhs);
+        auto urhs = static_cast<uint32_t>(rhs);
+
+        switch (funct3) {
+            case 0b000: // MUL
+                return static_cast<int32_t>(ulhs * urhs);
+
+            case 0b001: // MULH
+                return static_cast<int32_t>((static_cast<int64_t>(lhs) * rhs) >> 32);
+
+            case 0b010: // MULHSU
+                return static_cast<int32_t>((static_cast<int64_t>(lhs) * static_cast<int64_t>(urhs)) >> 32);
+
+            case 0b011: // MULHU
+                return static_cast<int32_t>((static_cast<uint64_t>(ulhs) * urhs) >> 32);
+
+            case 0b100: // DIV
+                if (rhs == 0)
+                    return -1;
+                if (lhs == INT32_MIN && rhs == -1)
+                    return INT32_MIN;
+                return lhs / rhs;
+
+            case 0b101: // DIVU
+                if (urhs == 0)
+                    return -1;
+                return static_cast<int32_t>(ulhs / urhs);
+
+            case 0b110: // REM
+                if (rhs == 0)
+                    return lhs;
+                if (lhs == INT32_MIN && rhs == -1)
+                    return 0;
+                return lhs % rhs;
+
+            case 0b111: // REMU
+                if (urhs == 0)
+                    return lhs;
+                return static_cast<int32_t>(ulhs % urhs);
+        }
+        throw std::runtime_error ("unknown funct3 for M extension instruction = " + std::to_string(funct3));
+    }
+
+    template <bool Debug>
+    int32_t loadData(int32_t address) const {
+        int32_t value = memory.read(address);
+        if constexpr (Debug) {
+            debug.onAccess(address, value, RV32I_WatchKind::Read);
+        }
+        return value;
+    }
+
+    template <bool Debug>
+    void storeData(int32_t address, int32_t value) {
+        memory.write(address, value);
+        if constexpr (Debug) {
+            debug.onAccess(address, value, RV32I_WatchKind::Write);
+        }
+    }
+
+    template <bool Debug, bool Trace>
+    void run() {
         while (pc < _amountInstructions) {
+            if constexpr (Debug) {
+                debug.onFetch(pc);
+            }
+            if constexpr (Trace) {
+                traceHook(pc, readMemory(pc));
+            }
             bool flagJump = false;
             int opcode = readMemory(pc) & 0x7F;
             int rd = (readMemory(pc) >> 7) & 0x1F;
@@ -88,6 +360,12 @@ public:
 
             switch (opcode) {
                 case 0b0110011: // R-type
+                    if constexpr (Config::M_EXTENSION) {
+                        if (funct7 == 0b0000001) {
+                            regfile.write(rd, executeMulDiv(funct3, regfile.read(rs1), regfile.read(rs2)));
+                            break;
+                        }
+                    }
                     switch (funct7) {
 
                         case 0b0000000:
@@ -111,12 +389,12 @@ public:
                     switch (funct3) {
 
                         case 0b000:
-                            regfile.write(rd, memory.read(load_address));
+                            regfile.write(rd, loadData<Debug>(load_address));
                             break;
 
                         case 0b001:
                             int16_t halfword;
-                            halfword = memory.read(load_address);
+                            halfword = loadData<Debug>(load_address);
 
                             if (halfword & 0x8000) {
                                 halfword |= 0xFFFF0000;
@@ -126,7 +404,7 @@ public:
 
                         case 0b010:
                             int32_t byte;
-                            byte = memory.read(load_address);
+                            byte = loadData<Debug>(load_address);
 
                             if (byte & 0x80) {
                                 byte |= 0xFFFFFF00;
@@ -167,15 +445,15 @@ public:
 
                     switch (funct3) {
                         case 0b000:
-                            memory.write(store_address, store_data & 0xFF);
+                            storeData<Debug>(store_address, store_data & 0xFF);
                             break;
 
                         case 0b001:
-                            memory.write(store_address, store_data & 0xFFFF);
+                            storeData<Debug>(store_address, store_data & 0xFFFF);
                             break;
 
                         case 0b010:
-                            memory.write(store_address, store_data);
+                            storeData<Debug>(store_address, store_data);
                             break;
 
                         default:
@@ -287,3 +565,8 @@ public:
         }
     }
 };
+
+using RV32I_Processor = RV32_Processor<RV32I_Config>;
+using RV32I_DebugProcessor = RV32_Processor<RV32I_DebugConfig>;
+using RV32IM_Processor = RV32_Processor<RV32IM_Config>;
+using RV32IM_FullProcessor = RV32_Processor<RV32IM_FullConfig>;
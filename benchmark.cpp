@@ -0,0 +1,43 @@
+#include "MyRV32_model.h"
+#include <chrono>
+#include <string>
+
+
+// Runs the same instruction stream on each configuration with no hooks set and prints the best of several runs.
+template <typename Processor>
+double runBenchmark(const std::vector<int32_t>& instructions, int repeats) {
+    double best = 0;
+
+    for (int i = 0; i < repeats; i++) {
+        Processor processor(instructions.size(), instructions.size());
+        processor.loadInstructionsMemory(instructions);
+
+        auto start = std::chrono::steady_clock::now();
+        processor.execute();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (processor.readRegister(1) != static_cast<int32_t>(instructions.size()))
+            throw std::runtime_error ("unexpected result in benchmark");
+
+        if (i == 0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int amountInstructions = argc > 1 ? std::stoi(argv[1]) : 4000000;
+    int repeats = argc > 2 ? std::stoi(argv[2]) : 10;
+
+    std::vector<int32_t> instructions(amountInstructions, 0x00108093);  // addi x1, x1, 1
+
+    // Warm-up run, so the first measured configuration does not pay for cold caches and CPU frequency ramp-up.
+    runBenchmark<RV32I_Processor>(instructions, repeats);
+
+    std::cout << "instructions: " << amountInstructions << ", best of " << repeats << " runs" << std::endl;
+    std::cout << "RV32I_Processor:      " << runBenchmark<RV32I_Processor>(instructions, repeats) << " ms" << std::endl;
+    std::cout << "RV32I_DebugProcessor: " << runBenchmark<RV32I_DebugProcessor>(instructions, repeats) << " ms" << std::endl;
+    std::cout << "RV32IM_FullProcessor: " << runBenchmark<RV32IM_FullProcessor>(instructions, repeats) << " ms" << std::endl;
+
+    return 0;
+}
@@ -366,4 +366,205 @@ TEST(Exseptions_test,  funct3_for_S_type){
         std::cerr << "Exception caught: " << e.what() << std::endl;
     }
 
-}
\ No newline at end of file
+}
+
+TEST(Debug_test, Breakpoint){
+    RV32I_DebugProcessor processor(1024, 3);
+    processor.writeRegister(3, 20);
+    processor.writeRegister(2, 10);
+    std::vector<int32_t> instr = {0b00000000001000000000001011101111, 0b00000000001100010000000010110011, 0b01000000001100010000000010110011};
+    processor.loadInstructionsMemory(instr);
+
+    std::vector<int32_t> hits;
+    processor.setBreakpoint(1, [&](int32_t pc) { hits.push_back(pc); });
+    processor.setBreakpoint(2, [&](int32_t pc) { hits.push_back(pc); });
+    processor.execute();
+
+    EXPECT_EQ(hits, std::vector<int32_t>({2}));
+    EXPECT_EQ(processor.readRegister(1), -10);
+}
+
+TEST(Debug_test, ClearBreakpoint){
+    RV32I_DebugProcessor processor(1024, 1);
+    processor.writeRegister(2, 5);
+    std::vector<int32_t> instr = {0b0000000001100010000000010010011};
+    processor.loadInstructionsMemory(instr);
+
+    int hits = 0;
+    processor.setBreakpoint(0, [&](int32_t) { hits++; });
+    processor.clearBreakpoint(0);
+    processor.execute();
+
+    EXPECT_EQ(hits, 0);
+    EXPECT_EQ(processor.readRegister(1), 8);
+}
+
+TEST(Debug_test, WriteWatchpoint){
+    RV32I_DebugProcessor processor(4096, 1);
+    processor.writeRegister(1, 3);
+    processor.writeRegister(2, 100);
+    std::vector<int32_t> instr = {0b00000000001000001010001110100011};
+    processor.loadInstructionsMemory(instr);
+
+    int32_t watchedAddress = -1, watchedValue = -1;
+    processor.addWatchpoint(8, 16, RV32I_WatchKind::Write, [&](int32_t address, int32_t value, RV32I_WatchKind) {
+        watchedAddress = address;
+        watchedValue = value;
+    });
+    processor.execute();
+
+    EXPECT_EQ(watchedAddress, 10);
+    EXPECT_EQ(watchedValue, 100);
+    EXPECT_EQ(processor.readMemory(10), 100);
+}
+
+TEST(Debug_test, ReadWatchpoint){
+    RV32I_DebugProcessor processor(4096, 1);
+    processor.writeMemory(3, 12345678);
+    std::vector<int32_t> instr = {0b00000000001100010000000100000011};
+    processor.loadInstructionsMemory(instr);
+
+    int reads = 0, writes = 0;
+    processor.addWatchpoint(3, 4, RV32I_WatchKind::Read, [&](int32_t, int32_t, RV32I_WatchKind) { reads++; });
+    int id = processor.addWatchpoint(3, 4, RV32I_WatchKind::Write, [&](int32_t, int32_t, RV32I_WatchKind) { writes++; });
+    processor.removeWatchpoint(id);
+    processor.execute();
+
+    EXPECT_EQ(reads, 1);
+    EXPECT_EQ(writes, 0);
+    EXPECT_EQ(processor.readRegister(2), 12345678);
+}
+
+TEST(Debug_test, OneShotBreakpoint){
+    RV32I_DebugProcessor processor(1024, 2);
+    processor.writeRegister(2, 5);
+    std::vector<int32_t> instr = {0b0000000001100010000000010010011, 0b0000000001100010000000010010011};
+    processor.loadInstructionsMemory(instr);
+
+    int hits = 0;
+    processor.setBreakpoint(0, [&](int32_t pc) {
+        processor.clearBreakpoint(pc);
+        hits++;
+    });
+    processor.execute();
+
+    EXPECT_EQ(hits, 1);
+    EXPECT_EQ(processor.readRegister(1), 8);
+}
+
+TEST(Debug_test, OneShotWatchpoint){
+    RV32I_DebugProcessor processor(4096, 2);
+    processor.writeRegister(1, 3);
+    processor.writeRegister(2, 100);
+    std::vector<int32_t> instr = {0b00000000001000001010001110100011, 0b00000000001000001010001110100011};
+    processor.loadInstructionsMemory(instr);
+
+    int hits = 0;
+    int id = 0;
+    id = processor.addWatchpoint(10, 11, RV32I_WatchKind::Write, [&](int32_t, int32_t, RV32I_WatchKind) {
+        processor.removeWatchpoint(id);
+        hits++;
+    });
+    processor.execute();
+
+    EXPECT_EQ(hits, 1);
+    EXPECT_EQ(processor.readMemory(10), 100);
+}
+
+TEST(Debug_test, OutOfMemoryRange){
+    RV32I_DebugProcessor processor(1024);
+    auto breakpointHook = [](int32_t) {};
+    auto watchpointHook = [](int32_t, int32_t, RV32I_WatchKind) {};
+
+    EXPECT_THROW(processor.setBreakpoint(1024, breakpointHook), std::runtime_error);
+    EXPECT_THROW(processor.setBreakpoint(INT32_MAX, breakpointHook), std::runtime_error);
+    EXPECT_THROW(processor.addWatchpoint(0, INT32_MAX, RV32I_WatchKind::Read, watchpointHook), std::runtime_error);
+    EXPECT_THROW(processor.addWatchpoint(-1, 4, RV32I_WatchKind::Read, watchpointHook), std::runtime_error);
+    EXPECT_NO_THROW(processor.setBreakpoint(1023, breakpointHook));
+    EXPECT_NO_THROW(processor.addWatchpoint(0, 1024, RV32I_WatchKind::ReadWrite, watchpointHook));
+}
+
+TEST(M_extension_test, MUL){
+    RV32IM_Processor processor(1024, 1);
+    processor.writeRegister(2, -7);
+    processor.writeRegister(3, 6);
+
+    std::vector<int32_t> instr = {0b00000010001100010000000010110011};
+    processor.loadInstructionsMemory(instr);
+    processor.execute();
+
+    EXPECT_EQ(processor.readRegister(1), -42);
+}
+
+TEST(M_extension_test, MULH){
+    RV32IM_Processor processor(1024, 1);
+    processor.writeRegister(2, INT32_MIN);
+    processor.writeRegister(3, 4);
+
+    std::vector<int32_t> instr = {0b00000010001100010001000010110011};
+    processor.loadInstructionsMemory(instr);
+    processor.execute();
+
+    EXPECT_EQ(processor.readRegister(1), -2);
+}
+
+TEST(M_extension_test, DIV){
+    RV32IM_Processor processor(1024, 1);
+    processor.writeRegister(2, -42);
+    processor.writeRegister(3, 5);
+
+    std::vector<int32_t> instr = {0b00000010001100010100000010110011};
+    processor.loadInstructionsMemory(instr);
+    processor.execute();
+
+    EXPECT_EQ(processor.readRegister(1), -8);
+}
+
+TEST(M_extension_test, DIV_by_zero){
+    RV32IM_Processor processor(1024, 1);
+    processor.writeRegister(2, 42);
+
+    std::vector<int32_t> instr = {0b00000010000000010100000010110011}; // DIV rd=1, rs1=2, rs2=0
+    processor.loadInstructionsMemory(instr);
+    processor.execute();
+
+    EXPECT_EQ(processor.readRegister(1), -1);
+}
+
+TEST(M_extension_test, REMU){
+    RV32IM_Processor processor(1024, 1);
+    processor.writeRegister(2, -1);
+    processor.writeRegister(3, 10);
+
+    std::vector<int32_t> instr = {0b00000010001100010111000010110011};
+    processor.loadInstructionsMemory(instr);
+    processor.execute();
+
+    EXPECT_EQ(processor.readRegister(1), 5);
+}
+
+TEST(M_extension_test, disabled_in_RV32I){
+    RV32I_Processor processor(1024, 1);
+    processor.writeRegister(2, -7);
+    processor.writeRegister(3, 6);
+
+    std::vector<int32_t> instr = {0b00000010001100010000000010110011};
+    processor.loadInstructionsMemory(instr);
+
+    EXPECT_THROW(processor.execute(), std::runtime_error);
+}
+
+TEST(Config_test, Trace){
+    RV32IM_FullProcessor processor(1024, 3);
+    processor.writeRegister(3, 20);
+    processor.writeRegister(2, 10);
+    std::vector<int32_t> instr = {0b00000000001000000000001011101111, 0b00000000001100010000000010110011, 0b01000000001100010000000010110011};
+    processor.loadInstructionsMemory(instr);
+
+    std::vector<int32_t> trace;
+    processor.setTraceHook([&](int32_t pc, int32_t) { trace.push_back(pc); });
+    processor.execute();
+
+    EXPECT_EQ(trace, std::vector<int32_t>({0, 2}));
+    EXPECT_EQ(processor.readRegister(1), -10);
+}